@@ -32,9 +32,16 @@
 #define __RAY_VarianceFilter__
 
 #include <RAY/RAY_PixelFilter.h>
+#include <UT/UT_SharedPtr.h>
+#include <SYS/SYS_Types.h>
 
 namespace HDK_Sample {
 
+struct RAY_VarianceCounters;
+class RAY_VarianceStats;
+class RAY_RefineWriter;
+class RAY_EdgePlanes;
+
 class RAY_VarianceFilter : public RAY_PixelFilter {
 public:
     RAY_VarianceFilter();
@@ -44,13 +51,35 @@ public:
 
     /// setArgs is called with the options specified after the pixel filter
     /// name in the Pixel Filter parameter on the Mantra ROP.
-    /// This filter accepts 5 options:
+    /// This filter accepts 14 options:
+    /// -m range    Select what's written to each pixel.  "range" writes the
+    ///             per-channel max minus min of the colour within the
+    ///             colour gradient region.  "edge" writes 1 where any enabled
+    ///             detector finds an edge, and 0 elsewhere.  "variance"
+    ///             and "stddev" write the per-channel variance or standard
+    ///             deviation of the colour within the colour gradient
+    ///             region.  "gradient" writes the per-channel magnitude of
+    ///             the least squares colour gradient, in colour units /
+    ///             pixel, over the same region.  "refine" writes the
+    ///             number of times more samples each pixel needs, based on
+    ///             the colour range, for the next pass of adaptive
+    ///             sampling, or 0 where it needs no more; see -a.
+    ///             The z-depth and Op ID checks are only used by "edge".
     /// -c 0.1      Consider a colour gradient of 0.1 colour units / pixel
     ///             to be an edge.  Make -1 to disable colour gradient check.
+    ///             For "edge" and "refine", this is checked as a colour
+    ///             range across the region of at least 0.1 times the
+    ///             smaller of its width and height.  If they differ,
+    ///             smaller gradients along the longer side are also
+    ///             considered edges, down to 0.1 times the ratio of the
+    ///             sides.
     /// -w 3.0      Make the width of the region to fit lines to for the
     ///             colour gradient 3.0 pixels, i.e. each pixel may depend on
-    ///             samples 1.5 pixels from its centre.  It gets clamped to
-    ///             a minimum width of 1.0.
+    ///             samples 1.5 pixels from its centre.  This sets the height
+    ///             too, unless -W is given.  Widths less than 1.0 slide the
+    ///             region across each pixel, taking the max of the results.
+    /// -W 3.0      Make the height of the colour gradient region 3.0 pixels,
+    ///             e.g. for non-square pixels.
     /// -z 0.005    Consider a z-depth gradient of a factor of 0.005 change
     ///             in the z-depth per pixel to be an edge.  For example,
     ///             a gradient of 0.51 distance units per pixel at a depth
@@ -58,16 +87,47 @@ public:
     ///             disable z-depth gradient check.
     /// -s 3.0      Make the width of the region to fit lines to for the
     ///             z-depth gradient 3.0 pixels, i.e. each pixel may depend on
-    ///             samples 1.5 pixels from its centre.  It gets clamped to
-    ///             a minimum width of 1.0.
+    ///             samples 1.5 pixels from its centre.  This sets the height
+    ///             too, unless -S is given.  Widths less than 1.0 slide the
+    ///             region across each pixel, taking the max of the results.
+    /// -S 3.0      Make the height of the z-depth gradient region 3.0 pixels.
     /// -o 3.0      Make the width of the region to search for varying Op IDs
     ///             3.0 pixels, i.e. each pixel may depend on
-    ///             samples 1.5 pixels from its centre.  It gets clamped to
-    ///             a minimum width of 1.0.  Make -1 to disable Op ID check.
+    ///             samples 1.5 pixels from its centre.  This sets the height
+    ///             too, unless -O is given.  It gets clamped to a minimum
+    ///             of 1.0.  Make -1 to disable Op ID check.
+    /// -O 3.0      Make the height of the Op ID region 3.0 pixels.
+    /// -t 1        Max number of threads to split each tile across.  The
+    ///             passes over the rows and columns of the tile are each
+    ///             split separately, and "edge" is split into blocks of
+    ///             pixels.  1 keeps each tile on the calling thread, and 0
+    ///             uses as many threads as are available.  Tiles too cheap
+    ///             to be worth splitting stay on the calling thread
+    ///             regardless.
+    /// -a 1        For "refine", write 1 where the colour range is at
+    ///             least the -c threshold, and 0 elsewhere.  Larger values
+    ///             write the whole number of times the range is the
+    ///             threshold, up to this many, as a multiplier for the
+    ///             number of samples.
+    /// -r refine.txt
+    ///             For "refine", write the runs of pixels in each row of
+    ///             each tile that need refinement to refine.txt, as they
+    ///             are filtered.  As with -p, tiles are identified by the
+    ///             order they were written.
+    /// -v          Count the pixels, samples and edges filtered, and the
+    ///             time spent in filter, per detector, and print a summary
+    ///             to stderr when the last clone of this filter is deleted.
+    /// -p costs.csv
+    ///             Write the size, samples, edges and time of each call to
+    ///             filter to costs.csv when the last clone of this filter
+    ///             is deleted.  Mantra doesn't tell pixel filters where
+    ///             tiles are, so they're written in the order they were
+    ///             started.
     virtual void setArgs(int argc, const char *const argv[]);
 
     /// getFilterWidth is called after setArgs when Mantra needs to know
-    /// how far to expand the render region.
+    /// how far to expand the render region.  Only the detectors used by
+    /// the output mode are included, separately for x and y.
     virtual void getFilterWidth(float &x, float &y) const;
 
     /// addNeededSpecialChannels is called after setArgs so that this filter
@@ -96,7 +156,181 @@ public:
         int destyoffsetinsource,
         const RAY_Imager &imager) const;
 
+    /// What filter writes to each destination pixel
+    enum OutputMode
+    {
+        /// Per-channel max minus min of the colour
+        OUTPUT_RANGE,
+        /// 1 for edge pixels, 0 elsewhere
+        OUTPUT_EDGE,
+        /// Per-channel variance of the colour
+        OUTPUT_VARIANCE,
+        /// Per-channel standard deviation of the colour
+        OUTPUT_STDDEV,
+        /// Per-channel magnitude of the colour gradient
+        OUTPUT_GRADIENT,
+        /// Refinement level from the max colour range over the channels,
+        /// in every channel
+        OUTPUT_REFINE
+    };
+
 private:
+    /// The samples that a detector reads along one axis, relative to the
+    /// first sample of each pixel.  If the detector's width is less than a
+    /// pixel, there are several windows in each pixel, one sample apart,
+    /// and the detector's result is the max over them.
+    struct SampleWindow
+    {
+        /// Offset of the first sample of the first window
+        int myStart;
+        /// Number of samples in each window
+        int myLength;
+        /// Number of windows in each pixel
+        int myCount;
+        /// Sum of the squared distances of the samples from the middle of
+        /// the window, in pixels, for fitting lines
+        float mySumX2;
+
+        /// Number of samples covered by all of the windows in a pixel
+        int extent() const { return myCount-1 + myLength; }
+    };
+
+    /// Computes the window along an axis with samplesperpixel samples
+    /// per pixel, for a detector width in pixels.
+    static SampleWindow computeWindow(int samplesperpixel, float width);
+
+    /// Returns the number of tasks to split n items across threads, where
+    /// each item reads about itemcost sample values, or 1 if they
+    /// shouldn't be split.  This is at most myMaxThreads, if that's
+    /// nonzero, and leaves enough work in each task to be worth
+    /// scheduling.
+    int getTaskCount(exint n, exint itemcost) const;
+
+    /// Writes the colour range of each pixel, using separable
+    /// sliding-window min and max, or if refine, the refinement levels
+    /// from refineRow.  The horizontal pass is split across threads by source
+    /// rows, and the vertical pass by columns of pixels.  If counters is
+    /// non-NULL, the tasks are added to it, and for refine, the pixels
+    /// needing refinement are added to it as edges.
+    void filterRange(
+        float *destination,
+        int vectorsize,
+        const float *colourdata,
+        int sourcewidth,
+        int destwidth,
+        int destheight,
+        int destxoffsetinsource,
+        int destyoffsetinsource,
+        bool refine,
+        RAY_VarianceCounters *counters) const;
+
+    /// Writes the colour variance, standard deviation, or gradient
+    /// magnitude of each pixel, using integral images of the colour
+    /// moments over the tile.  The rows of the integral images between
+    /// each pair of rows that are kept are summed in separate tasks, and
+    /// the lookups are split across threads by columns of pixels.
+    /// If counters is non-NULL, the tasks are added to it.
+    void filterMoments(
+        float *destination,
+        int vectorsize,
+        const float *colourdata,
+        int sourcewidth,
+        int destwidth,
+        int destheight,
+        int destxoffsetinsource,
+        int destyoffsetinsource,
+        RAY_VarianceCounters *counters) const;
+
+    /// Writes the refinement level of each of destwidth pixels to all of
+    /// its channels, from the max of its colour ranges in ranges, which
+    /// are overwritten.  Returns the number of pixels needing refinement.
+    exint refineRow(
+        float *destination,
+        float *ranges,
+        int destwidth,
+        int vectorsize) const;
+
+    /// Writes the edge mask, with the tile split across threads into
+    /// blocks of pixels, each written by filterEdgeBlocks.  The data for
+    /// disabled detectors may be NULL.  If counters is non-NULL, the
+    /// tasks, and the samples read and edges found by each detector, are
+    /// added to it.
+    void filterEdges(
+        float *destination,
+        int vectorsize,
+        const float *colourdata,
+        const float *zdata,
+        const float *opiddata,
+        int sourcewidth,
+        int destwidth,
+        int destheight,
+        int destxoffsetinsource,
+        int destyoffsetinsource,
+        RAY_VarianceCounters *counters) const;
+
+    /// Writes the edge mask for a block of pixels of filterEdges, with
+    /// destination rows deststride floats apart.  The union of the
+    /// windows of the detectors covers extentx by extenty samples,
+    /// starting firstx and firsty from the first sample of each pixel.
+    /// If the samples under a row of pixels don't fit in cache, this
+    /// runs filterEdgePixels on smaller blocks of pixels, reading planes,
+    /// one per channel, that rows of the samples are copied into as
+    /// they're first read.
+    void filterEdgeBlocks(
+        float *destination,
+        exint deststride,
+        int vectorsize,
+        const float *colourdata,
+        const float *zdata,
+        const float *opiddata,
+        int sourcewidth,
+        int destwidth,
+        int destheight,
+        int destxoffsetinsource,
+        int destyoffsetinsource,
+        int firstx,
+        int firsty,
+        int extentx,
+        int extenty,
+        RAY_VarianceCounters *counters) const;
+
+    /// Returns the width and height in pixels of the blocks for
+    /// filterEdgeBlocks, or INT_MAX if the pixels shouldn't be split,
+    /// given the detectors used and the extent in samples of the union of
+    /// their windows.
+    int getEdgeBlockSize(
+        int vectorsize,
+        bool usecolour,
+        bool usez,
+        bool useopid,
+        int extentx,
+        int extenty,
+        int destwidth) const;
+
+    /// Writes the edge mask for filterEdges, running all enabled detectors
+    /// in one pass over the samples of each pixel.  Destination rows are
+    /// deststride floats apart.  Colour channel i of sample j is
+    /// colourdata[j*coloursamplestride + i*colourchannelstride], so this
+    /// can read either interleaved samples or planes.  If planes is
+    /// non-NULL, the data are its planes, and each row is fetched into
+    /// them before it's read.
+    void filterEdgePixels(
+        float *destination,
+        exint deststride,
+        int vectorsize,
+        const float *colourdata,
+        int coloursamplestride,
+        exint colourchannelstride,
+        const float *zdata,
+        const float *opiddata,
+        int sourcewidth,
+        int destwidth,
+        int destheight,
+        int destxoffsetinsource,
+        int destyoffsetinsource,
+        RAY_EdgePlanes *planes,
+        RAY_VarianceCounters *counters) const;
+
     /// These must be saved in prepFilter.
     /// Each pixel has mySamplesPerPixelX*mySamplesPerPixelY samples.
     /// @{
@@ -113,6 +347,15 @@ private:
     /// true iff detecting edges using changes in the Operator ID
     bool myUseOpID;
 
+    /// What to write to each destination pixel
+    OutputMode myOutputMode;
+
+    /// Max number of threads to split each tile across, or 0 for no limit
+    int myMaxThreads;
+
+    /// Max refinement level written by "refine", at least 1
+    int myRefineLevels;
+
     /// Min magnitude of the colour gradient that will be considered an edge
     /// Units are: colour units / pixel
     float myColourGradientThreshold;
@@ -121,32 +364,41 @@ private:
     /// Units are: distance units / pixel
     float myZGradientThreshold;
 
-    /// Width in pixels of filter to determine colour gradient
-    float myColourGradientWidth;
-
-    /// Width in pixels of filter to determine z-depth gradient
-    float myZGradientWidth;
+    /// Width and height in pixels of filter to determine colour gradient
+    /// @{
+    float myColourGradientWidthX;
+    float myColourGradientWidthY;
+    /// @}
 
-    /// Width in pixels of filter to check for different Operator IDs
-    float myOpIDWidth;
+    /// Width and height in pixels of filter to determine z-depth gradient
+    /// @{
+    float myZGradientWidthX;
+    float myZGradientWidthY;
+    /// @}
 
-    /// Normalizing coefficients computed in prepFilter
+    /// Width and height in pixels of filter to check for different
+    /// Operator IDs
     /// @{
-    float myColourSumX2;
-    float myColourSumY2;
-    float myZSumX2;
-    float myZSumY2;
+    float myOpIDWidthX;
+    float myOpIDWidthY;
     /// @}
 
-    /// Filter half-widths (rounded down) in sample counts
+    /// Sample windows of each detector, computed in prepFilter
     /// @{
-    int myColourSamplesHalfX;
-    int myColourSamplesHalfY;
-    int myZSamplesHalfX;
-    int myZSamplesHalfY;
-    int myOpIDSamplesHalfX;
-    int myOpIDSamplesHalfY;
+    SampleWindow myColourWindowX;
+    SampleWindow myColourWindowY;
+    SampleWindow myZWindowX;
+    SampleWindow myZWindowY;
+    SampleWindow myOpIDWindowX;
+    SampleWindow myOpIDWindowY;
     /// @}
+
+    /// Counters shared with all clones, or NULL unless -v or -p is given
+    UT_SharedPtr<RAY_VarianceStats> myStats;
+
+    /// Writer for refinement runs shared with all clones, or NULL unless
+    /// -r is given in "refine" mode
+    UT_SharedPtr<RAY_RefineWriter> myRefineWriter;
 };
 
 } // End HDK_Sample namespace
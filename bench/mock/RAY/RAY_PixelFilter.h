@@ -0,0 +1,78 @@
+/*
+ * Minimal stand-in for the HDK header of the same name, so that
+ * RAY_VarianceFilter can be built and benchmarked without Houdini.
+ */
+
+#pragma once
+
+#ifndef __RAY_PixelFilter__
+#define __RAY_PixelFilter__
+
+#include "RAY_SpecialChannel.h"
+#include <vector>
+
+/// The sample data for each channel, indexed by channel number.
+/// Channel 0 is the plane being filtered, and special channels are
+/// numbered from 1, in the order they were requested.
+class RAY_SampleBuffer
+{
+public:
+    std::vector<const float *> myChannels;
+};
+
+/// Keeps track of which special channels were requested, and what
+/// channel numbers they were given.
+class RAY_Imager
+{
+public:
+    RAY_Imager()
+        : myNextChannel(1)
+    {
+        for (int i = 0; i < RAY_SPECIAL_NUM; ++i)
+            mySpecialChannels[i] = -1;
+    }
+
+    int mySpecialChannels[RAY_SPECIAL_NUM];
+    int myNextChannel;
+};
+
+class RAY_PixelFilter
+{
+public:
+    virtual ~RAY_PixelFilter() {}
+
+    virtual RAY_PixelFilter *clone() const = 0;
+    virtual void setArgs(int argc, const char *const argv[]) {}
+    virtual void getFilterWidth(float &x, float &y) const = 0;
+    virtual void addNeededSpecialChannels(RAY_Imager &imager) {}
+    virtual void prepFilter(int samplesperpixelx, int samplesperpixely) {}
+    virtual void filter(
+        float *destination,
+        int vectorsize,
+        const RAY_SampleBuffer &source,
+        int channel,
+        int sourcewidth,
+        int sourceheight,
+        int destwidth,
+        int destheight,
+        int destxoffsetinsource,
+        int destyoffsetinsource,
+        const RAY_Imager &imager) const = 0;
+
+protected:
+    static const float *getSampleData(const RAY_SampleBuffer &source, int channel)
+    {
+        return source.myChannels[channel];
+    }
+    void addSpecialChannel(RAY_Imager &imager, RAY_SpecialChannel special)
+    {
+        if (imager.mySpecialChannels[special] < 0)
+            imager.mySpecialChannels[special] = imager.myNextChannel++;
+    }
+    int getSpecialChannelIdx(const RAY_Imager &imager, RAY_SpecialChannel special) const
+    {
+        return imager.mySpecialChannels[special];
+    }
+};
+
+#endif
@@ -0,0 +1,18 @@
+/*
+ * Minimal stand-in for the HDK header of the same name, so that
+ * RAY_VarianceFilter can be built and benchmarked without Houdini.
+ */
+
+#pragma once
+
+#ifndef __RAY_SpecialChannel__
+#define __RAY_SpecialChannel__
+
+enum RAY_SpecialChannel
+{
+    RAY_SPECIAL_PZ,
+    RAY_SPECIAL_OPID,
+    RAY_SPECIAL_NUM
+};
+
+#endif
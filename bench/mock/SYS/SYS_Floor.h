@@ -0,0 +1,18 @@
+/*
+ * Minimal stand-in for the HDK header of the same name, so that
+ * RAY_VarianceFilter can be built and benchmarked without Houdini.
+ */
+
+#pragma once
+
+#ifndef __SYS_Floor__
+#define __SYS_Floor__
+
+#include <math.h>
+
+inline float SYSfloor(float v) { return floorf(v); }
+inline double SYSfloor(double v) { return floor(v); }
+inline float SYSceil(float v) { return ceilf(v); }
+inline double SYSceil(double v) { return ceil(v); }
+
+#endif
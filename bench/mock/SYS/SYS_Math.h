@@ -0,0 +1,25 @@
+/*
+ * Minimal stand-in for the HDK header of the same name, so that
+ * RAY_VarianceFilter can be built and benchmarked without Houdini.
+ */
+
+#pragma once
+
+#ifndef __SYS_Math__
+#define __SYS_Math__
+
+#include "SYS_Types.h"
+#include <math.h>
+
+template <typename T> inline T SYSmin(T a, T b) { return a < b ? a : b; }
+template <typename T> inline T SYSmax(T a, T b) { return a > b ? a : b; }
+template <typename T> inline T SYSmin(T a, T b, T c) { return SYSmin(SYSmin(a, b), c); }
+template <typename T> inline T SYSmax(T a, T b, T c) { return SYSmax(SYSmax(a, b), c); }
+template <typename T> inline T SYSclamp(T v, T lo, T hi) { return v < lo ? lo : (v > hi ? hi : v); }
+
+inline float SYSsqrt(float v) { return sqrtf(v); }
+inline double SYSsqrt(double v) { return sqrt(v); }
+inline float SYSabs(float v) { return fabsf(v); }
+inline double SYSabs(double v) { return fabs(v); }
+
+#endif
@@ -0,0 +1,19 @@
+/*
+ * Minimal stand-in for the HDK header of the same name, so that
+ * RAY_VarianceFilter can be built and benchmarked without Houdini.
+ */
+
+#pragma once
+
+#ifndef __SYS_Types__
+#define __SYS_Types__
+
+#include <stdint.h>
+
+typedef int32_t int32;
+typedef int64_t int64;
+typedef int64_t exint;
+typedef float fpreal32;
+typedef double fpreal64;
+
+#endif
@@ -0,0 +1,83 @@
+/*
+ * Minimal stand-in for the HDK header of the same name, so that
+ * RAY_VarianceFilter can be built and benchmarked without Houdini.
+ */
+
+#pragma once
+
+#ifndef __UT_Args__
+#define __UT_Args__
+
+#include <stdlib.h>
+#include <string.h>
+
+/// Single-character options, each with at most one argument
+class UT_Args
+{
+public:
+    UT_Args()
+        : myArgc(0)
+        , myArgv(0)
+    {
+        clearOptions();
+    }
+
+    void initialize(int argc, const char *const argv[])
+    {
+        myArgc = argc;
+        myArgv = argv;
+    }
+
+    /// options is like getopt's, e.g. "c:w:v" for -c and -w with arguments
+    void stripOptions(const char *options)
+    {
+        clearOptions();
+        for (int i = 1; i < myArgc; ++i)
+        {
+            const char *arg = myArgv[i];
+            if (arg[0] != '-' || !arg[1] || arg[2])
+                continue;
+            const char *option = strchr(options, arg[1]);
+            if (!option)
+                continue;
+            const int c = (unsigned char)arg[1];
+            ++myFound[c];
+            if (option[1] == ':' && i+1 < myArgc)
+                myValues[c] = myArgv[++i];
+        }
+    }
+
+    int found(char c) const
+    {
+        return myFound[(unsigned char)c];
+    }
+    const char *argp(char c, int = 0) const
+    {
+        return myValues[(unsigned char)c] ? myValues[(unsigned char)c] : "";
+    }
+    float fargp(char c, int = 0) const
+    {
+        return (float)atof(argp(c));
+    }
+    int iargp(char c, int = 0) const
+    {
+        return atoi(argp(c));
+    }
+
+private:
+    void clearOptions()
+    {
+        for (int i = 0; i < 256; ++i)
+        {
+            myFound[i] = 0;
+            myValues[i] = 0;
+        }
+    }
+
+    int myArgc;
+    const char *const *myArgv;
+    int myFound[256];
+    const char *myValues[256];
+};
+
+#endif
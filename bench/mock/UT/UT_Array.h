@@ -0,0 +1,39 @@
+/*
+ * Minimal stand-in for the HDK header of the same name, so that
+ * RAY_VarianceFilter can be built and benchmarked without Houdini.
+ */
+
+#pragma once
+
+#ifndef __UT_Array__
+#define __UT_Array__
+
+#include <SYS/SYS_Types.h>
+#include <algorithm>
+#include <vector>
+
+template <typename T>
+class UT_Array
+{
+public:
+    exint entries() const { return exint(myData.size()); }
+    void setSize(exint n) { myData.resize(n); }
+    // std::vector always initializes, but that only affects timing.
+    void setSizeNoInit(exint n) { myData.resize(n); }
+    exint append(const T &t) { myData.push_back(t); return exint(myData.size())-1; }
+    void clear() { myData.clear(); }
+    template <typename COMPARATOR>
+    void stdsort(COMPARATOR isless) { std::sort(myData.begin(), myData.end(), isless); }
+
+    T *array() { return myData.data(); }
+    const T *array() const { return myData.data(); }
+    T &operator()(exint i) { return myData[i]; }
+    const T &operator()(exint i) const { return myData[i]; }
+    T &operator[](exint i) { return myData[i]; }
+    const T &operator[](exint i) const { return myData[i]; }
+
+private:
+    std::vector<T> myData;
+};
+
+#endif
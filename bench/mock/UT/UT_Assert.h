@@ -0,0 +1,15 @@
+/*
+ * Minimal stand-in for the HDK header of the same name, so that
+ * RAY_VarianceFilter can be built and benchmarked without Houdini.
+ */
+
+#pragma once
+
+#ifndef __UT_Assert__
+#define __UT_Assert__
+
+#include <assert.h>
+
+#define UT_ASSERT(ZZ) assert(ZZ)
+
+#endif
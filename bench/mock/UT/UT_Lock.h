@@ -0,0 +1,37 @@
+/*
+ * Minimal stand-in for the HDK header of the same name, so that
+ * RAY_VarianceFilter can be built and benchmarked without Houdini.
+ */
+
+#pragma once
+
+#ifndef __UT_Lock__
+#define __UT_Lock__
+
+#include <mutex>
+
+class UT_Lock
+{
+public:
+    void lock() { myMutex.lock(); }
+    void unlock() { myMutex.unlock(); }
+
+    /// Locks for the lifetime of the scope object
+    class Scope
+    {
+    public:
+        explicit Scope(UT_Lock &lock)
+            : myLock(lock)
+        { myLock.lock(); }
+        ~Scope() { myLock.unlock(); }
+    private:
+        Scope(const Scope &);
+        Scope &operator=(const Scope &);
+        UT_Lock &myLock;
+    };
+
+private:
+    std::mutex myMutex;
+};
+
+#endif
@@ -0,0 +1,96 @@
+/*
+ * Minimal stand-in for the HDK header of the same name, so that
+ * RAY_VarianceFilter can be built and benchmarked without Houdini.
+ * Ranges are split the way TBB splits them, in halves until they're no
+ * larger than the grain size, so the body sees ranges of anywhere between
+ * about half the grain size and the grain size.  Instead of TBB's work
+ * stealing, there's one thread per core taking ranges from a shared
+ * counter.
+ */
+
+#pragma once
+
+#ifndef __UT_ParallelUtil__
+#define __UT_ParallelUtil__
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+template <typename T>
+class UT_BlockedRange
+{
+public:
+    UT_BlockedRange(T begin, T end, size_t grainsize = 1)
+        : myBegin(begin)
+        , myEnd(end)
+        , myGrainSize(grainsize ? grainsize : 1)
+    {}
+
+    T begin() const { return myBegin; }
+    T end() const { return myEnd; }
+    size_t size() const { return size_t(myEnd - myBegin); }
+    size_t grainsize() const { return myGrainSize; }
+    bool empty() const { return !(myBegin < myEnd); }
+
+    /// Like tbb::blocked_range::is_divisible
+    bool is_divisible() const { return size() > myGrainSize; }
+
+    /// Splits off and returns the upper half, like tbb::blocked_range's
+    /// splitting constructor
+    UT_BlockedRange split()
+    {
+        const T middle = T(myBegin + (myEnd - myBegin)/2u);
+        UT_BlockedRange upper(middle, myEnd, myGrainSize);
+        myEnd = middle;
+        return upper;
+    }
+
+private:
+    T myBegin;
+    T myEnd;
+    size_t myGrainSize;
+};
+
+template <typename T>
+void
+UTsplitRange(UT_BlockedRange<T> range, std::vector<UT_BlockedRange<T> > &ranges)
+{
+    if (range.empty())
+        return;
+    if (!range.is_divisible())
+    {
+        ranges.push_back(range);
+        return;
+    }
+    const UT_BlockedRange<T> upper = range.split();
+    UTsplitRange(range, ranges);
+    UTsplitRange(upper, ranges);
+}
+
+template <typename T, typename Body>
+void
+UTparallelFor(const UT_BlockedRange<T> &range, const Body &body)
+{
+    std::vector<UT_BlockedRange<T> > ranges;
+    UTsplitRange(range, ranges);
+    const size_t nthreads = std::min<size_t>(ranges.size(),
+        std::max(1u, std::thread::hardware_concurrency()));
+
+    std::atomic<size_t> next(0);
+    auto worker = [&]()
+    {
+        for (size_t task; (task = next++) < ranges.size(); )
+            body(ranges[task]);
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < nthreads; ++i)
+        threads.push_back(std::thread(worker));
+    worker();
+    for (size_t i = 0; i < threads.size(); ++i)
+        threads[i].join();
+}
+
+#endif
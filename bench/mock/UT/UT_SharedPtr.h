@@ -0,0 +1,23 @@
+/*
+ * Minimal stand-in for the HDK header of the same name, so that
+ * RAY_VarianceFilter can be built and benchmarked without Houdini.
+ */
+
+#pragma once
+
+#ifndef __UT_SharedPtr__
+#define __UT_SharedPtr__
+
+#include <memory>
+
+template <typename T>
+using UT_SharedPtr = std::shared_ptr<T>;
+
+template <typename T, typename... ARGS>
+UT_SharedPtr<T>
+UTmakeShared(ARGS &&... args)
+{
+    return std::make_shared<T>(std::forward<ARGS>(args)...);
+}
+
+#endif
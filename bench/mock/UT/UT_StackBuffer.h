@@ -0,0 +1,31 @@
+/*
+ * Minimal stand-in for the HDK header of the same name, so that
+ * RAY_VarianceFilter can be built and benchmarked without Houdini.
+ */
+
+#pragma once
+
+#ifndef __UT_StackBuffer__
+#define __UT_StackBuffer__
+
+#include <stddef.h>
+#include <vector>
+
+template <typename T>
+class UT_StackBuffer
+{
+public:
+    explicit UT_StackBuffer(size_t n)
+        : myData(n)
+    {}
+
+    T &operator[](size_t i) { return myData[i]; }
+    const T &operator[](size_t i) const { return myData[i]; }
+    T *array() { return myData.data(); }
+    const T *array() const { return myData.data(); }
+
+private:
+    std::vector<T> myData;
+};
+
+#endif
@@ -0,0 +1,36 @@
+/*
+ * Minimal stand-in for the HDK header of the same name, so that
+ * RAY_VarianceFilter can be built and benchmarked without Houdini.
+ */
+
+#pragma once
+
+#ifndef __UT_StopWatch__
+#define __UT_StopWatch__
+
+#include <SYS/SYS_Types.h>
+#include <chrono>
+
+/// Wall clock timer
+class UT_StopWatch
+{
+    typedef std::chrono::steady_clock Clock;
+
+public:
+    UT_StopWatch()
+        : myStart(Clock::now())
+    {}
+
+    void start() { myStart = Clock::now(); }
+
+    /// Seconds since start(), without stopping
+    fpreal64 lap() const
+    {
+        return std::chrono::duration<fpreal64>(Clock::now() - myStart).count();
+    }
+
+private:
+    Clock::time_point myStart;
+};
+
+#endif
@@ -0,0 +1,51 @@
+/*
+ * Minimal stand-in for the HDK header of the same name, so that
+ * RAY_VarianceFilter can be built and benchmarked without Houdini.
+ */
+
+#pragma once
+
+#ifndef __UT_ThreadSpecificValue__
+#define __UT_ThreadSpecificValue__
+
+#include <map>
+#include <mutex>
+#include <thread>
+
+/// One value per thread, default-constructed on first use by each thread
+template <typename T>
+class UT_ThreadSpecificValue
+{
+    typedef std::map<std::thread::id, T> ValueMap;
+
+public:
+    T &get()
+    {
+        // std::map never moves its values, so the reference stays valid.
+        std::lock_guard<std::mutex> lock(myLock);
+        return myValues[std::this_thread::get_id()];
+    }
+
+    class iterator
+    {
+    public:
+        explicit iterator(typename ValueMap::iterator it)
+            : myIt(it)
+        {}
+        T &get() const { return myIt->second; }
+        iterator &operator++() { ++myIt; return *this; }
+        bool operator==(const iterator &that) const { return myIt == that.myIt; }
+        bool operator!=(const iterator &that) const { return myIt != that.myIt; }
+    private:
+        typename ValueMap::iterator myIt;
+    };
+
+    iterator begin() { return iterator(myValues.begin()); }
+    iterator end() { return iterator(myValues.end()); }
+
+private:
+    std::mutex myLock;
+    ValueMap myValues;
+};
+
+#endif